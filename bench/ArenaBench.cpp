@@ -0,0 +1,160 @@
+#include "Bench.h"
+
+#include "Arena.h"
+
+#include <cstdlib>
+#include <memory_resource>
+#include <random>
+
+namespace
+{
+    using namespace ADS;
+
+    // number of blocks alive at once during churn
+    constexpr size_t CHURN_LIVE = 64;
+    // allocations made per churn iteration
+    constexpr size_t CHURN_OPS = 1024;
+    // blocks allocated and freed per bulk iteration
+    constexpr size_t BULK_COUNT = 512;
+
+    constexpr size_t MIN_BLOCK = 16;
+    constexpr size_t MAX_BLOCK = 256;
+
+    std::vector<size_t> blockSizes(size_t count)
+    {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<size_t> dist(MIN_BLOCK, MAX_BLOCK);
+
+        std::vector<size_t> sizes(count);
+
+        for (size_t& size : sizes)
+            size = dist(rng);
+
+        return sizes;
+    }
+
+    // every pattern takes an alloc function returning a handle to a block of the passed size, and a free function taking that handle.
+
+    // CHURN:
+    // a fixed number of blocks are kept alive, and every operation frees the oldest block and allocates a new one of a random size.
+    // this is the steady state of a long running arena, where the free memory slowly fragments.
+
+    template<typename TAlloc, typename TFree>
+    void churn(Bench::State& state, TAlloc alloc, TFree free)
+    {
+        std::vector<size_t> sizes = blockSizes(CHURN_OPS);
+        std::vector<decltype(alloc(0))> live;
+
+        for (size_t i = 0; i < CHURN_LIVE; i++)
+            live.push_back(alloc(sizes[i]));
+
+        size_t oldest = 0;
+
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < CHURN_OPS; i++)
+            {
+                free(live[oldest]);
+                live[oldest] = alloc(sizes[i]);
+                Bench::doNotOptimize(live[oldest]);
+
+                oldest = (oldest + 1) % CHURN_LIVE;
+            }
+        }
+
+        for (auto& ptr : live)
+            free(ptr);
+    }
+
+    // BULK:
+    // a batch of blocks is allocated, and then every block is freed in allocation order, like a per frame or per request arena.
+
+    template<typename TAlloc, typename TFree>
+    void bulk(Bench::State& state, TAlloc alloc, TFree free)
+    {
+        std::vector<size_t> sizes = blockSizes(BULK_COUNT);
+        std::vector<decltype(alloc(0))> live;
+        live.reserve(BULK_COUNT);
+
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < BULK_COUNT; i++)
+                live.push_back(alloc(sizes[i]));
+
+            Bench::doNotOptimize(live.data());
+
+            for (auto& ptr : live)
+                free(ptr);
+
+            live.clear();
+        }
+    }
+
+    // the live blocks of a churn need at most this many bytes, with a block header each.
+    constexpr size_t CHURN_ARENA_SIZE = 64 * 1024;
+    constexpr size_t BULK_ARENA_SIZE = 256 * 1024;
+
+    template<typename TPattern>
+    void runAll(Bench::Runner& runner, const std::string& pattern, size_t ops, size_t arena_size, TPattern run_pattern)
+    {
+        runner.run("arena/" + pattern + "/malloc", ops, [&](Bench::State& state)
+            {
+                run_pattern(state, [](size_t size) { return std::malloc(size); }, [](void* ptr) { std::free(ptr); });
+            });
+
+        runner.run("arena/" + pattern + "/pmr_unsynchronized_pool", ops, [&](Bench::State& state)
+            {
+                std::pmr::unsynchronized_pool_resource pool;
+
+                // the pool needs the size on deallocation, so it is stored in front of the block like StaticArena does.
+                run_pattern(state,
+                    [&](size_t size)
+                    {
+                        size_t* block = (size_t*)pool.allocate(size + sizeof(size_t));
+                        *block = size;
+                        return (void*)(block + 1);
+                    },
+                    [&](void* ptr)
+                    {
+                        size_t* block = (size_t*)ptr - 1;
+                        pool.deallocate(block, *block + sizeof(size_t));
+                    });
+            });
+
+        runner.run("arena/" + pattern + "/StaticArena", ops, [&](Bench::State& state)
+            {
+                StaticArena arena(arena_size);
+
+                run_pattern(state, [&](size_t size) { return arena.alloc<byte>(size); }, [&](byte* ptr) { arena.free(ptr); });
+            });
+
+        runner.run("arena/" + pattern + "/ModArena", ops, [&](Bench::State& state)
+            {
+                ModArena arena(arena_size);
+
+                run_pattern(state, [&](size_t size) { return arena.alloc<byte>(size); }, [&](const ArenaPtr<byte>& ptr) { arena.free(ptr); });
+            });
+    }
+}
+
+void arenaBenchmarks(ADS::Bench::Runner& runner)
+{
+    runAll(runner, "churn", CHURN_OPS, CHURN_ARENA_SIZE, [](Bench::State& state, auto alloc, auto free) { churn(state, alloc, free); });
+    runAll(runner, "bulk", BULK_COUNT, BULK_ARENA_SIZE, [](Bench::State& state, auto alloc, auto free) { bulk(state, alloc, free); });
+
+    // a monotonic buffer can not free single blocks, so it only takes part in the bulk pattern, releasing everything at once.
+    runner.run("arena/bulk/pmr_monotonic", BULK_COUNT, [](Bench::State& state)
+        {
+            std::vector<size_t> sizes = blockSizes(BULK_COUNT);
+            std::vector<byte> buffer(BULK_ARENA_SIZE);
+            std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size());
+
+            for (auto _ : state)
+            {
+                for (size_t i = 0; i < BULK_COUNT; i++)
+                    Bench::doNotOptimize(resource.allocate(sizes[i]));
+
+                resource.release();
+            }
+        });
+}
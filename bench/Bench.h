@@ -0,0 +1,227 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// minimal micro benchmark harness, modeled after google benchmark.
+//
+// a benchmark is a function taking a State, which runs the measured code inside a "for (auto _ : state)" loop.
+// code before the loop is setup and not measured, and state.pause() / state.resume() can exclude parts of an iteration.
+// the runner calibrates the number of iterations so a run lasts at least --min-time milliseconds,
+// and repeats every run --repetitions times, reporting the median time per operation.
+namespace ADS::Bench
+{
+    // prevents the compiler from optimizing away the computation of value.
+    template<typename T>
+    inline void doNotOptimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const T* sink;
+        sink = &value;
+#endif
+    }
+
+    class State
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // the value of the loop variable in "for (auto _ : state)".
+        // the user provided destructor makes it non trivial, so compilers do not warn about the variable being unused.
+        struct Value
+        {
+            ~Value() {}
+        };
+
+        struct Iterator
+        {
+            State* state;
+            size_t remaining;
+
+            bool operator!=(const Iterator&) const
+            {
+                if (remaining > 0)
+                    return true;
+
+                state->pause();
+                return false;
+            }
+
+            void operator++() { remaining--; }
+            Value operator*() const { return {}; }
+        };
+
+        State(size_t iterations) : m_iterations(iterations) {}
+
+        size_t iterations() const { return m_iterations; }
+
+        Iterator begin() { resume(); return { this, m_iterations }; }
+        Iterator end() { return { this, 0 }; }
+
+        void pause()
+        {
+            if (!m_running) return;
+
+            m_elapsed += Clock::now() - m_start;
+            m_running = false;
+        }
+
+        void resume()
+        {
+            if (m_running) return;
+
+            m_start = Clock::now();
+            m_running = true;
+        }
+
+        double elapsedNs() const { return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(m_elapsed).count(); }
+
+    private:
+        size_t m_iterations;
+        bool m_running = false;
+        Clock::time_point m_start;
+        Clock::duration m_elapsed = Clock::duration::zero();
+    };
+
+    struct Result
+    {
+        std::string name;
+        size_t ops_per_iteration;
+        size_t iterations;
+        size_t repetitions;
+        double median_ns;
+        double min_ns;
+        double max_ns;
+    };
+
+    class Runner
+    {
+    public:
+        // accepts --filter=<substring>, --json=<path>, --repetitions=<n> and --min-time=<milliseconds>.
+        Runner(int argc, char** argv)
+        {
+            for (int i = 1; i < argc; i++)
+            {
+                std::string arg = argv[i];
+
+                if (arg.rfind("--filter=", 0) == 0)
+                    m_filter = arg.substr(9);
+                else if (arg.rfind("--json=", 0) == 0)
+                    m_json_path = arg.substr(7);
+                else if (arg.rfind("--repetitions=", 0) == 0)
+                    m_repetitions = std::max(1, std::stoi(arg.substr(14)));
+                else if (arg.rfind("--min-time=", 0) == 0)
+                    m_min_time_ns = std::stod(arg.substr(11)) * 1e6;
+                else
+                {
+                    std::cerr << "unknown argument: " << arg << '\n'
+                        << "usage: " << argv[0] << " [--filter=<substring>] [--json=<path>] [--repetitions=<n>] [--min-time=<ms>]\n";
+                    m_failed = true;
+                }
+            }
+        }
+
+        bool failed() const { return m_failed; }
+
+        // runs func if name matches the filter.
+        // ops_per_iteration is the number of operations a single iteration performs, results are reported per operation.
+        template<typename TFunc>
+        void run(const std::string& name, size_t ops_per_iteration, TFunc func)
+        {
+            if (m_failed || name.find(m_filter) == std::string::npos)
+                return;
+
+            // grow the iteration count until a single run takes at least the minimum time.
+            size_t iterations = 1;
+
+            while (true)
+            {
+                State state(iterations);
+                func(state);
+
+                double elapsed = state.elapsedNs();
+
+                if (elapsed >= m_min_time_ns || iterations >= (size_t(1) << 30))
+                    break;
+
+                double factor = elapsed > 0 ? m_min_time_ns * 1.2 / elapsed : 10;
+                iterations = (size_t)(iterations * std::clamp(factor, 2.0, 10.0));
+            }
+
+            std::vector<double> samples;
+
+            for (int i = 0; i < m_repetitions; i++)
+            {
+                State state(iterations);
+                func(state);
+                samples.push_back(state.elapsedNs() / (double)(iterations * ops_per_iteration));
+            }
+
+            std::sort(samples.begin(), samples.end());
+
+            Result result{ name, ops_per_iteration, iterations, samples.size(), samples[samples.size() / 2], samples.front(), samples.back() };
+
+            std::cout << std::left << std::setw(48) << result.name << std::right
+                << std::setw(14) << std::fixed << std::setprecision(2) << result.median_ns << " ns/op"
+                << std::setw(12) << result.iterations << " iterations\n";
+
+            m_results.push_back(result);
+        }
+
+        // writes the json report if requested, and returns the exit code of the benchmark executable.
+        int finish() const
+        {
+            if (m_failed)
+                return 1;
+
+            if (m_json_path.empty())
+                return 0;
+
+            std::ofstream file(m_json_path);
+
+            file << "{\n  \"benchmarks\": [\n";
+
+            for (size_t i = 0; i < m_results.size(); i++)
+            {
+                const Result& result = m_results[i];
+
+                file << "    {\"name\": \"" << result.name << "\""
+                    << ", \"ops_per_iteration\": " << result.ops_per_iteration
+                    << ", \"iterations\": " << result.iterations
+                    << ", \"repetitions\": " << result.repetitions
+                    << std::setprecision(4) << std::fixed
+                    << ", \"median_ns_per_op\": " << result.median_ns
+                    << ", \"min_ns_per_op\": " << result.min_ns
+                    << ", \"max_ns_per_op\": " << result.max_ns << '}'
+                    << (i + 1 < m_results.size() ? ",\n" : "\n");
+            }
+
+            file << "  ]\n}\n";
+
+            if (!file)
+            {
+                std::cerr << "failed to write " << m_json_path << '\n';
+                return 1;
+            }
+
+            return 0;
+        }
+
+    private:
+        std::string m_filter;
+        std::string m_json_path;
+        int m_repetitions = 5;
+        double m_min_time_ns = 50e6;
+        bool m_failed = false;
+
+        std::vector<Result> m_results;
+    };
+}
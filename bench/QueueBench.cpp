@@ -0,0 +1,234 @@
+#include "Bench.h"
+
+#include "FixedQueue.h"
+
+#include <deque>
+#include <random>
+
+#ifdef ADS_BENCH_BOOST
+#include <boost/circular_buffer.hpp>
+#endif
+
+namespace
+{
+    using namespace ADS;
+
+    // capacity of every queue, i.e. the length of the sliding window
+    constexpr size_t WINDOW = 1024;
+    // values pushed per window_push iteration
+    constexpr size_t PUSH_OPS = 4096;
+    // values pushed between every scan of the window
+    constexpr size_t SCAN_BATCH = 64;
+    // values pushed and popped per fifo iteration
+    constexpr size_t FIFO_BURST = 32;
+
+    // a minimal ring buffer with the semantics of boost::circular_buffer, where pushing to a full buffer overwrites the front.
+    // used as the baseline for FixedQueue when boost is not available.
+    template<typename T>
+    class RingBuffer
+    {
+    public:
+        RingBuffer(size_t capacity) : m_data(capacity) {}
+
+        void push_back(T val)
+        {
+            m_data[(m_front + m_size) % m_data.size()] = val;
+
+            if (m_size < m_data.size())
+                m_size++;
+            else
+                m_front = (m_front + 1) % m_data.size();
+        }
+
+        void pop_front() { m_front = (m_front + 1) % m_data.size(); m_size--; }
+
+        T& front() { return m_data[m_front]; }
+
+        size_t size() const { return m_size; }
+
+        template<typename TFunc>
+        void forEach(TFunc func) const
+        {
+            for (size_t i = 0; i < m_size; i++)
+                func(m_data[(m_front + i) % m_data.size()]);
+        }
+
+    private:
+        std::vector<T> m_data;
+        size_t m_front = 0;
+        size_t m_size = 0;
+    };
+
+    std::vector<int> values()
+    {
+        std::mt19937 rng(7);
+        std::vector<int> vals(PUSH_OPS);
+
+        for (int& val : vals)
+            val = (int)(rng() % 1000);
+
+        return vals;
+    }
+
+    // every queue is driven through the same three adapters, so the patterns only have to be written once.
+    // push adds a value, dropping the front if the window is full. pop drops the front. sum iterates the whole window.
+
+    template<typename TQueue>
+    struct FixedAdapter
+    {
+        TQueue queue;
+
+        void push(int val) { queue.push_back(val); }
+        void pop() { queue.pop_front(); }
+
+        long long sum()
+        {
+            long long result = 0;
+
+            for (int val : queue)
+                result += val;
+
+            return result;
+        }
+    };
+
+    struct DequeAdapter
+    {
+        std::deque<int> queue;
+
+        void push(int val)
+        {
+            queue.push_back(val);
+
+            if (queue.size() > WINDOW)
+                queue.pop_front();
+        }
+
+        void pop() { queue.pop_front(); }
+
+        long long sum()
+        {
+            long long result = 0;
+
+            for (int val : queue)
+                result += val;
+
+            return result;
+        }
+    };
+
+    struct RingAdapter
+    {
+        RingBuffer<int> queue{ WINDOW };
+
+        void push(int val) { queue.push_back(val); }
+        void pop() { queue.pop_front(); }
+
+        long long sum()
+        {
+            long long result = 0;
+            queue.forEach([&](int val) { result += val; });
+            return result;
+        }
+    };
+
+#ifdef ADS_BENCH_BOOST
+    struct BoostAdapter
+    {
+        boost::circular_buffer<int> queue{ WINDOW };
+
+        void push(int val) { queue.push_back(val); }
+        void pop() { queue.pop_front(); }
+
+        long long sum()
+        {
+            long long result = 0;
+
+            for (int val : queue)
+                result += val;
+
+            return result;
+        }
+    };
+#endif
+
+    // WINDOW_PUSH:
+    // values are pushed into a full window, so every push also drops the oldest value.
+    template<typename TAdapter>
+    void windowPush(Bench::State& state, TAdapter& adapter)
+    {
+        std::vector<int> vals = values();
+
+        for (size_t i = 0; i < WINDOW; i++)
+            adapter.push(vals[i]);
+
+        for (auto _ : state)
+        {
+            for (int val : vals)
+                adapter.push(val);
+
+            Bench::doNotOptimize(adapter);
+        }
+    }
+
+    // WINDOW_SUM:
+    // a batch of values is pushed into a full window, after which the whole window is iterated, like a moving average.
+    template<typename TAdapter>
+    void windowSum(Bench::State& state, TAdapter& adapter)
+    {
+        std::vector<int> vals = values();
+
+        for (size_t i = 0; i < WINDOW; i++)
+            adapter.push(vals[i]);
+
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < SCAN_BATCH; i++)
+                adapter.push(vals[i]);
+
+            Bench::doNotOptimize(adapter.sum());
+        }
+    }
+
+    // FIFO:
+    // bursts of values are pushed to a half full queue, and then popped again, like a producer consumer buffer.
+    template<typename TAdapter>
+    void fifo(Bench::State& state, TAdapter& adapter)
+    {
+        std::vector<int> vals = values();
+
+        for (size_t i = 0; i < WINDOW / 2; i++)
+            adapter.push(vals[i]);
+
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < FIFO_BURST; i++)
+                adapter.push(vals[i]);
+
+            for (size_t i = 0; i < FIFO_BURST; i++)
+                adapter.pop();
+
+            Bench::doNotOptimize(adapter);
+        }
+    }
+
+    template<typename TAdapter, typename TMake>
+    void runAll(Bench::Runner& runner, const std::string& name, TMake make)
+    {
+        runner.run("queue/window_push/" + name, PUSH_OPS, [&](Bench::State& state) { TAdapter adapter = make(); windowPush(state, adapter); });
+        runner.run("queue/window_sum/" + name, SCAN_BATCH, [&](Bench::State& state) { TAdapter adapter = make(); windowSum(state, adapter); });
+        runner.run("queue/fifo/" + name, FIFO_BURST * 2, [&](Bench::State& state) { TAdapter adapter = make(); fifo(state, adapter); });
+    }
+}
+
+void queueBenchmarks(ADS::Bench::Runner& runner)
+{
+    runAll<FixedAdapter<FixedQueue<int>>>(runner, "FixedQueue", []() { return FixedAdapter<FixedQueue<int>>{ FixedQueue<int>(WINDOW) }; });
+    runAll<FixedAdapter<SFixedQueue<int, WINDOW>>>(runner, "SFixedQueue", []() { return FixedAdapter<SFixedQueue<int, WINDOW>>{}; });
+    runAll<DequeAdapter>(runner, "std_deque", []() { return DequeAdapter{}; });
+    runAll<RingAdapter>(runner, "ring_buffer", []() { return RingAdapter{}; });
+
+#ifdef ADS_BENCH_BOOST
+    runAll<BoostAdapter>(runner, "boost_circular_buffer", []() { return BoostAdapter{}; });
+#endif
+}
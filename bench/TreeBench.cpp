@@ -0,0 +1,294 @@
+#include "Bench.h"
+
+#include "BinaryTree.h"
+#include "ConcurrentTree.h"
+#include "TreeFile.h"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <set>
+#include <shared_mutex>
+#include <thread>
+
+namespace
+{
+    using namespace ADS;
+
+    // elements in the random trees
+    constexpr size_t TREE_SIZE = 100000;
+    // elements in the sorted trees, SNode does not rebalance so sorted inserts are quadratic and degenerate into a list.
+    constexpr size_t SORTED_SIZE = 2000;
+    // lookups per lookup iteration
+    constexpr size_t LOOKUP_OPS = 4096;
+    // distinct values in the duplicate heavy trees
+    constexpr size_t DUPLICATE_KEYS = 4;
+    // threads looking up values while a single writer modifies the tree
+    constexpr size_t READER_THREADS = 4;
+
+    // random even values, so odd values can be used for lookups that miss.
+    std::vector<int> randomValues(size_t count, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<int> vals(count);
+
+        for (int& val : vals)
+            val = (int)(rng() % (count * 8)) * 2;
+
+        return vals;
+    }
+
+    std::vector<int> duplicateValues(size_t count)
+    {
+        std::mt19937 rng(3);
+        std::vector<int> vals(count);
+
+        for (int& val : vals)
+            val = (int)(rng() % DUPLICATE_KEYS);
+
+        return vals;
+    }
+
+    std::vector<int> sortedValues(size_t count)
+    {
+        std::vector<int> vals(count);
+        std::iota(vals.begin(), vals.end(), 0);
+        return vals;
+    }
+
+    // BUILD:
+    // a tree is built from a vector, and destroyed outside of the measured time.
+    template<typename TBuild, typename TDestroy>
+    void build(Bench::State& state, const std::vector<int>& vals, TBuild build_tree, TDestroy destroy_tree)
+    {
+        for (auto _ : state)
+        {
+            auto tree = build_tree(vals);
+            Bench::doNotOptimize(tree);
+
+            state.pause();
+            destroy_tree(tree);
+            state.resume();
+        }
+    }
+
+    void buildAll(Bench::Runner& runner, const std::string& pattern, const std::vector<int>& vals)
+    {
+        runner.run("tree/" + pattern + "/SNode", vals.size(), [&](Bench::State& state)
+            {
+                build(state, vals, [](const std::vector<int>& v) { return SNode<int>::fromVector(v); }, [](SNode<int>* tree) { delete tree; });
+            });
+
+        runner.run("tree/" + pattern + "/SNode_parallel", vals.size(), [&](Bench::State& state)
+            {
+                build(state, vals, [](const std::vector<int>& v) { return SNode<int>::fromVectorParallel(v); }, [](SNode<int>* tree) { delete tree; });
+            });
+
+        runner.run("tree/" + pattern + "/CSTree", vals.size(), [&](Bench::State& state)
+            {
+                build(state, vals, [](const std::vector<int>& v) { return CSTree<int>::fromVector(v); }, [](CSTree<int>* tree) { delete tree; });
+            });
+
+        runner.run("tree/" + pattern + "/std_set", vals.size(), [&](Bench::State& state)
+            {
+                build(state, vals, [](const std::vector<int>& v) { return new std::set<int>(v.begin(), v.end()); }, [](std::set<int>* tree) { delete tree; });
+            });
+    }
+
+    // LOOKUP:
+    // random lookups in a tree built from random values, either all hitting or all missing.
+    template<typename TLookup>
+    void lookup(Bench::State& state, const std::vector<int>& keys, TLookup lookup_key)
+    {
+        for (auto _ : state)
+        {
+            size_t found = 0;
+
+            for (int key : keys)
+                found += lookup_key(key);
+
+            Bench::doNotOptimize(found);
+        }
+    }
+
+    void lookupAll(Bench::Runner& runner, const std::string& pattern, const std::vector<int>& vals, const std::vector<int>& keys)
+    {
+        runner.run("tree/" + pattern + "/SNode", keys.size(), [&](Bench::State& state)
+            {
+                std::unique_ptr<SNode<int>> tree(SNode<int>::fromVector(vals));
+                lookup(state, keys, [&](int key) { return tree->lookup(key) != nullptr; });
+            });
+
+        runner.run("tree/" + pattern + "/SNode_balanced", keys.size(), [&](Bench::State& state)
+            {
+                std::unique_ptr<SNode<int>> tree(SNode<int>::fromVectorParallel(vals));
+                lookup(state, keys, [&](int key) { return tree->lookup(key) != nullptr; });
+            });
+
+        runner.run("tree/" + pattern + "/CSTree", keys.size(), [&](Bench::State& state)
+            {
+                std::unique_ptr<CSTree<int>> tree(CSTree<int>::fromVector(vals));
+                auto snapshot = tree->snapshot();
+                lookup(state, keys, [&](int key) { return snapshot.contains(key); });
+            });
+
+        runner.run("tree/" + pattern + "/MappedTree", keys.size(), [&](Bench::State& state)
+            {
+                std::filesystem::path path = std::filesystem::temp_directory_path() / "ADStruct_bench.adst";
+
+                {
+                    std::unique_ptr<SNode<int>> tree(SNode<int>::fromVectorParallel(vals));
+                    std::ofstream file(path, std::ios::binary);
+                    writeTree(file, tree.get());
+                }
+
+                MappedTree<int> tree(path.string());
+                lookup(state, keys, [&](int key) { return tree.lookup(key) != nullptr; });
+
+                tree.close();
+                std::filesystem::remove(path);
+            });
+
+        runner.run("tree/" + pattern + "/std_set", keys.size(), [&](Bench::State& state)
+            {
+                std::set<int> tree(vals.begin(), vals.end());
+                lookup(state, keys, [&](int key) { return tree.find(key) != tree.end(); });
+            });
+    }
+
+    // CONCURRENT_LOOKUP:
+    // every iteration READER_THREADS threads each look up every key, while a writer thread keeps inserting and removing odd values.
+    // read_keys is called from every reader with an offset into keys, and returns the number of keys found.
+    // thread creation is part of the measured time, but is the same for every tree.
+    template<typename TRead, typename TWrite>
+    void concurrentLookup(Bench::State& state, const std::vector<int>& keys, TRead read_keys, TWrite write)
+    {
+        std::atomic<bool> stop = false;
+
+        std::thread writer([&]()
+            {
+                for (int i = 0; !stop.load(std::memory_order_relaxed); i = (i + 1) % (int)TREE_SIZE)
+                    write(i * 2 + 1);
+            });
+
+        for (auto _ : state)
+        {
+            std::vector<std::thread> readers;
+
+            for (size_t i = 0; i < READER_THREADS; i++)
+                readers.emplace_back([&, i]() { Bench::doNotOptimize(read_keys(keys, i * keys.size() / READER_THREADS)); });
+
+            for (std::thread& reader : readers)
+                reader.join();
+        }
+
+        stop = true;
+        writer.join();
+    }
+
+    void concurrentLookupAll(Bench::Runner& runner, const std::vector<int>& vals, const std::vector<int>& keys)
+    {
+        size_t ops = keys.size() * READER_THREADS;
+
+        // every lookup pins its own snapshot, which includes the cost of claiming and releasing a reader slot.
+        runner.run("tree/concurrent_lookup/CSTree_snapshot_per_lookup", ops, [&](Bench::State& state)
+            {
+                std::unique_ptr<CSTree<int>> tree(CSTree<int>::fromVector(vals));
+
+                concurrentLookup(state, keys,
+                    [&](const std::vector<int>& k, size_t offset)
+                    {
+                        size_t found = 0;
+
+                        for (size_t i = 0; i < k.size(); i++)
+                            found += tree->contains(k[(offset + i) % k.size()]);
+
+                        return found;
+                    },
+                    [&](int val) { tree->insert(val); tree->remove(val); });
+            });
+
+        runner.run("tree/concurrent_lookup/CSTree_shared_snapshot", ops, [&](Bench::State& state)
+            {
+                std::unique_ptr<CSTree<int>> tree(CSTree<int>::fromVector(vals));
+
+                concurrentLookup(state, keys,
+                    [&](const std::vector<int>& k, size_t offset)
+                    {
+                        auto snapshot = tree->snapshot();
+                        size_t found = 0;
+
+                        for (size_t i = 0; i < k.size(); i++)
+                            found += snapshot.contains(k[(offset + i) % k.size()]);
+
+                        return found;
+                    },
+                    [&](int val) { tree->insert(val); tree->remove(val); });
+            });
+
+        runner.run("tree/concurrent_lookup/std_set_shared_mutex", ops, [&](Bench::State& state)
+            {
+                std::set<int> tree(vals.begin(), vals.end());
+                std::shared_mutex mutex;
+
+                concurrentLookup(state, keys,
+                    [&](const std::vector<int>& k, size_t offset)
+                    {
+                        size_t found = 0;
+
+                        for (size_t i = 0; i < k.size(); i++)
+                        {
+                            std::shared_lock lock(mutex);
+                            found += tree.find(k[(offset + i) % k.size()]) != tree.end();
+                        }
+
+                        return found;
+                    },
+                    [&](int val)
+                    {
+                        std::unique_lock lock(mutex);
+                        tree.insert(val);
+                        tree.erase(val);
+                    });
+            });
+    }
+}
+
+void treeBenchmarks(ADS::Bench::Runner& runner)
+{
+    std::vector<int> vals = randomValues(TREE_SIZE, 1);
+
+    buildAll(runner, "build_random", vals);
+    buildAll(runner, "build_sorted", sortedValues(SORTED_SIZE));
+
+    // inserting equal values one by one degenerates SNode and CSTree into a list, so only the bulk build takes part.
+    std::vector<int> duplicates = duplicateValues(TREE_SIZE);
+
+    runner.run("tree/build_duplicates/SNode_parallel", duplicates.size(), [&](Bench::State& state)
+        {
+            build(state, duplicates, [](const std::vector<int>& v) { return SNode<int>::fromVectorParallel(v); }, [](SNode<int>* tree) { delete tree; });
+        });
+
+    runner.run("tree/build_duplicates/std_multiset", duplicates.size(), [&](Bench::State& state)
+        {
+            build(state, duplicates, [](const std::vector<int>& v) { return new std::multiset<int>(v.begin(), v.end()); }, [](std::multiset<int>* tree) { delete tree; });
+        });
+
+    std::vector<int> hits(LOOKUP_OPS);
+    std::vector<int> misses(LOOKUP_OPS);
+    std::mt19937 rng(2);
+
+    for (size_t i = 0; i < LOOKUP_OPS; i++)
+    {
+        hits[i] = vals[rng() % vals.size()];
+        misses[i] = hits[i] + 1;
+    }
+
+    lookupAll(runner, "lookup_hit", vals, hits);
+    lookupAll(runner, "lookup_miss", vals, misses);
+
+    concurrentLookupAll(runner, vals, hits);
+}
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""compares two ADStruct_bench json reports.
+
+usage: compare.py <baseline.json> <contender.json> [--threshold 0.10]
+
+prints the change in median time per operation for every benchmark present in both reports,
+and exits with 1 if any benchmark became slower than the threshold allows.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as file:
+        return {bench["name"]: bench for bench in json.load(file)["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="compare two ADStruct_bench json reports.")
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative slowdown reported as a regression (default 0.10 = 10%%)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    contender = load(args.contender)
+
+    regressions = []
+
+    print(f"{'benchmark':<48}{'baseline':>14}{'contender':>14}{'change':>10}")
+
+    for name, old in baseline.items():
+        new = contender.get(name)
+
+        if new is None:
+            print(f"{name:<48}{old['median_ns_per_op']:>14.2f}{'missing':>14}")
+            continue
+
+        old_ns = old["median_ns_per_op"]
+        new_ns = new["median_ns_per_op"]
+        change = (new_ns - old_ns) / old_ns if old_ns > 0 else 0.0
+
+        marker = ""
+
+        if change > args.threshold:
+            marker = "  REGRESSION"
+            regressions.append(name)
+        elif change < -args.threshold:
+            marker = "  improved"
+
+        print(f"{name:<48}{old_ns:>14.2f}{new_ns:>14.2f}{change:>+10.1%}{marker}")
+
+    for name in contender.keys() - baseline.keys():
+        print(f"{name:<48}{'new':>14}{contender[name]['median_ns_per_op']:>14.2f}")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) regressed by more than {args.threshold:.0%}")
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,19 @@
+#include "Bench.h"
+
+void arenaBenchmarks(ADS::Bench::Runner& runner);
+void queueBenchmarks(ADS::Bench::Runner& runner);
+void treeBenchmarks(ADS::Bench::Runner& runner);
+
+int main(int argc, char** argv)
+{
+    ADS::Bench::Runner runner(argc, argv);
+
+    if (runner.failed())
+        return runner.finish();
+
+    arenaBenchmarks(runner);
+    queueBenchmarks(runner);
+    treeBenchmarks(runner);
+
+    return runner.finish();
+}
@@ -1,12 +1,17 @@
 #pragma once
 
 #include <cstdlib>
+#include <cstring>
+#include <algorithm>
 #include <vector>
+#include <list>
 #include <tuple>
 #include <iostream>
 #include <memory>
 #include <cassert>
 
+#include "ArenaStats.h"
+
 namespace ADS
 {
     typedef unsigned char byte;
@@ -60,11 +65,16 @@ namespace ADS
             stream << '\n';
         }
 
+        // returns the layout of the arena, along with the allocation counters if ADS_ARENA_STATS is defined.
+        // walks every memory block, so it should not be called on every allocation.
+        ArenaStatsSnapshot stats() const;
+
 
     private:
         // ARENA STRUCTURE DEFINITION:
         // a memory block starts of with an 8/4 byte (depending on architecture) value representing the size of the block, followed by the actual data of the block.
-        // MEM_BLOCK = BLOCK_SIZE + DATA...
+        // the data is padded to a multiple of alignof(size_t), so the block size of the next memory block is always aligned.
+        // MEM_BLOCK = BLOCK_SIZE + DATA... + PADDING
         // ARENA = MEM_BLOCK + UNUSED_MEM
         // the address returned by alloc will point to the start of MEM and not BLOCK_SIZE.
         // the unused memory in an arena is always zero initialized, thus making it possible to see what parts of the arena are in use.
@@ -72,12 +82,17 @@ namespace ADS
         byte* m_arena;
         size_t m_arena_size;
 
+        ADS_NO_UNIQUE_ADDRESS ArenaStats m_stats;
+
     private:
 
         // finds an adress that has enough memory to store the passed memory block size.
         // returns a nullptr if no address were found.
         byte* findFreeAddress(size_t size);
 
+        // returns the number of bytes a memory block with the passed data size occupies after its block size, including the padding.
+        static size_t blockSpan(size_t size) { return (size + alignof(size_t) - 1) / alignof(size_t) * alignof(size_t); }
+
     };
     
 
@@ -113,12 +128,19 @@ namespace ADS
 
     public:
 
-        ArenaPtr(ArenaPtr<T>& other)
+        ArenaPtr(const ArenaPtr<T>& other)
             : m_mem_info(other.m_mem_info), m_pos(other.m_pos) {}
 
+        ArenaPtr& operator=(const ArenaPtr<T>& other)
+        {
+            m_mem_info = other.m_mem_info;
+            m_pos = other.m_pos;
+            return *this;
+        }
+
         // cast constructor
         template<typename TOther>
-        ArenaPtr(ArenaPtr<TOther>& other) : m_mem_info(other.blockInfo()), m_pos((T*)(TOther*)other) {}
+        ArenaPtr(const ArenaPtr<TOther>& other) : m_mem_info(other.blockInfo()), m_pos((T*)(const TOther*)other) {}
 
         ArenaPtr& operator=(const void* const other)
         {
@@ -170,12 +192,12 @@ namespace ADS
     class ArenaPtr<void> : public ArenaPtr<char>
     {
     public:
-        ArenaPtr(ArenaPtr<void>& other)
+        ArenaPtr(const ArenaPtr<void>& other)
             : ArenaPtr<char>(other) {}
 
         // cast constructor
         template<typename TOther>
-        ArenaPtr(ArenaPtr<TOther>& other) : ArenaPtr<char>(other) {}
+        ArenaPtr(const ArenaPtr<TOther>& other) : ArenaPtr<char>(other) {}
 
         void operator[](size_t) = delete;
         void operator->() = delete;
@@ -221,6 +243,9 @@ namespace ADS
             stream << '\n';
         }
 
+        // returns the layout of the arena, along with the allocation counters if ADS_ARENA_STATS is defined.
+        ArenaStatsSnapshot stats() const;
+
     private:
 
         // ARENA STRUCTURE DEFINITION:
@@ -230,17 +255,20 @@ namespace ADS
         // MEM_BLOCK = DATA...
         // ARENA = MEM_BLOCK + UNUSED_MEM
         // MEM_INFO = [MEM_BLOCK_START, MEM_BLOCK_END]...
+        // MEM_INFO is sorted by MEM_BLOCK_START, and is a list so the addresses held by ArenaPtr stay valid when other blocks are allocated or freed.
         // the unused memory in the arena is always zero initialized.
 
         byte* m_arena;
         size_t m_arena_size;
 
 
-        std::vector<MemBlockInfo> m_mem_info;
+        std::list<MemBlockInfo> m_mem_info;
+
+        ADS_NO_UNIQUE_ADDRESS ArenaStats m_stats;
 
         // finds an adress that has enough memory to store the passed memory block size.
-        // returns a nullptr if no address were found.
-        std::pair<byte*, size_t> findFreeAddress(size_t size);
+        // returns a nullptr if no address were found, otherwise the address and the position in m_mem_info the block should be inserted at.
+        std::pair<byte*, std::list<MemBlockInfo>::iterator> findFreeAddress(size_t size);
     };
 
 
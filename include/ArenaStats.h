@@ -0,0 +1,176 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// the empty ArenaStats takes up no space inside the arenas. msvc ignores the standard attribute, and only honors its own.
+#ifdef _MSC_VER
+#define ADS_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define ADS_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+namespace ADS
+{
+    // a histogram with power of two buckets.
+    // bucket i counts values with a bit width of i, meaning bucket 0 counts zeros and bucket i counts values in [2^(i - 1), 2^i).
+    struct ArenaHistogram
+    {
+        static constexpr size_t BUCKETS = 65;
+
+        std::array<uint64_t, BUCKETS> buckets = {};
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t max = 0;
+
+        void record(uint64_t value)
+        {
+            buckets[std::bit_width(value)]++;
+            count++;
+            sum += value;
+            max = value > max ? value : max;
+        }
+
+        // returns the upper bound of the bucket containing the passed percentile (0 - 1).
+        uint64_t percentile(double p) const;
+
+        // returns the largest value that can be counted by the bucket.
+        static uint64_t upperBound(size_t bucket) { return bucket == 0 ? 0 : UINT64_MAX >> (64 - bucket); }
+    };
+
+    // a snapshot of the state of an arena, returned by StaticArena::stats and ModArena::stats.
+    struct ArenaStatsSnapshot
+    {
+        // layout metrics, found by walking the arena when the snapshot is taken.
+        // these are always available.
+
+        size_t arena_bytes = 0;
+        size_t live_bytes = 0;
+        size_t live_blocks = 0;
+        size_t free_bytes = 0;
+        size_t largest_free_extent = 0;
+        // 1 - largest_free_extent / free_bytes.
+        // 0 means all free memory is contiguous, close to 1 means it is split into many small extents.
+        double fragmentation = 0;
+
+        // counters, which are only recorded when ADS_ARENA_STATS is defined.
+
+        bool counters_enabled = false;
+        size_t high_water_bytes = 0;
+        size_t allocs = 0;
+        size_t frees = 0;
+        size_t failed_allocs = 0;
+
+        ArenaHistogram alloc_sizes;
+        ArenaHistogram free_sizes;
+        ArenaHistogram alloc_latency_ns;
+        ArenaHistogram free_latency_ns;
+
+        std::string toJson() const;
+
+        // returns the snapshot in the prometheus text exposition format, with every metric name starting with prefix.
+        std::string toPrometheus(const std::string& prefix = "ads_arena") const;
+    };
+
+    // ADS_ARENA_STATS changes the layout of StaticArena and ModArena,
+    // so StaticArena.cpp, ModArena.cpp and every file including Arena.h must be built with the same definition.
+    // mixing them violates the one definition rule, and the arenas will read their members at the wrong offsets.
+    // the ADS_ARENA_STATS cmake option defines it for every target linking ADStruct.
+#ifdef ADS_ARENA_STATS
+
+    // records allocation counters for an arena.
+    // the arenas call this on every alloc and free, so it is only compiled in when ADS_ARENA_STATS is defined.
+    class ArenaStats
+    {
+    public:
+        // measures the latency of a single alloc or free.
+        class Timer
+        {
+        public:
+            uint64_t elapsed() const
+            {
+                return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+            }
+
+        private:
+            std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+        };
+
+        void onAlloc(size_t bytes, uint64_t latency_ns, bool success)
+        {
+            m_alloc_latency_ns.record(latency_ns);
+
+            if (!success)
+            {
+                m_failed_allocs++;
+                return;
+            }
+
+            m_allocs++;
+            m_alloc_sizes.record(bytes);
+
+            m_live_bytes += bytes;
+            m_high_water_bytes = m_live_bytes > m_high_water_bytes ? m_live_bytes : m_high_water_bytes;
+        }
+
+        void onFree(size_t bytes, uint64_t latency_ns)
+        {
+            m_frees++;
+            m_free_sizes.record(bytes);
+            m_free_latency_ns.record(latency_ns);
+
+            m_live_bytes -= bytes;
+        }
+
+        // the live bytes are no longer tracked, but the high water mark is kept.
+        void onClear() { m_live_bytes = 0; }
+
+        void fill(ArenaStatsSnapshot& snapshot) const
+        {
+            snapshot.counters_enabled = true;
+            snapshot.high_water_bytes = m_high_water_bytes;
+            snapshot.allocs = m_allocs;
+            snapshot.frees = m_frees;
+            snapshot.failed_allocs = m_failed_allocs;
+            snapshot.alloc_sizes = m_alloc_sizes;
+            snapshot.free_sizes = m_free_sizes;
+            snapshot.alloc_latency_ns = m_alloc_latency_ns;
+            snapshot.free_latency_ns = m_free_latency_ns;
+        }
+
+    private:
+        size_t m_live_bytes = 0;
+        size_t m_high_water_bytes = 0;
+        size_t m_allocs = 0;
+        size_t m_frees = 0;
+        size_t m_failed_allocs = 0;
+
+        ArenaHistogram m_alloc_sizes;
+        ArenaHistogram m_free_sizes;
+        ArenaHistogram m_alloc_latency_ns;
+        ArenaHistogram m_free_latency_ns;
+    };
+
+#else
+
+    // empty version of ArenaStats, every call is optimized away.
+    class ArenaStats
+    {
+    public:
+        class Timer
+        {
+        public:
+            constexpr uint64_t elapsed() const { return 0; }
+        };
+
+        void onAlloc(size_t, uint64_t, bool) {}
+        void onFree(size_t, uint64_t) {}
+        void onClear() {}
+        void fill(ArenaStatsSnapshot&) const {}
+    };
+
+#endif
+};
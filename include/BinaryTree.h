@@ -5,6 +5,7 @@
 #include <concepts>
 #include <string>
 #include <vector>
+#include <thread>
 
 namespace ADS
 {
@@ -46,18 +47,40 @@ namespace ADS
 			void toStringHelper(std::string& str, std::string padding, std::string pointer, const NodeBase<T, TNode>* node) const;
 
 		};
+
+		// returns thread_count, or the number of hardware threads if thread_count is 0.
+		inline size_t threadCount(size_t thread_count)
+		{
+			if (thread_count == 0)
+				thread_count = std::thread::hardware_concurrency();
+
+			return thread_count > 0 ? thread_count : 1;
+		}
+
+		// number of nodes parallelTraverse visits on the calling thread, before any other thread is started.
+		constexpr size_t PARALLEL_TRAVERSE_SERIAL_NODES = 4096;
+
+		// traverses every node of the tree from root using thread_count threads, in no particular order.
+		//
+		// the first PARALLEL_TRAVERSE_SERIAL_NODES nodes are visited on the calling thread, and threads are only started if the traversal has not ended by then.
+		// starting threads costs more than visiting thousands of nodes, so small trees and searches which stop early never pay for it.
+		// the threads are started and joined on every call, no pool is kept between calls.
+		//
+		// each thread searches its own subtree depth first, and hands out part of its subtree whenever its work queue has been emptied by other threads,
+		// so idle threads can steal work from busy ones without the tree being split up front.
+		// visit is called concurrently from different threads, and the traversal stops early once visit returns true.
+		template<typename TNode, typename TVisit>
+		void parallelTraverse(TNode* root, TVisit visit, size_t thread_count);
 	}
 
 	// standard binary tree node type
 	template<typename T>
 	struct Node: Bases::NodeBase<T, Node>
 	{
-		Node(T val = T(), Node<T>* left = nullptr, Node<T>* right = nullptr) : NodeBase<T, Node>(val, left, right){}
-
-		
+		Node(T val = T(), Node<T>* left = nullptr, Node<T>* right = nullptr) : Bases::NodeBase<T, Node>(val, left, right){}
 
-		Node<T>* left = nullptr;
-		Node<T>* right = nullptr;
+		using Bases::NodeBase<T, Node>::left;
+		using Bases::NodeBase<T, Node>::right;
 
 		void insertLeft(Node<T>* new_node);
 		void insertLeft(T new_val);
@@ -66,16 +89,35 @@ namespace ADS
 		void insertRight(T new_val);
 
 		Node<T>* lookup(T val);
+
+		// returns a node where pred(node->val) is true, or nullptr if no such node exists.
+		// the tree is searched by up to thread_count threads (0 = hardware threads), which stop as soon as a match is found.
+		// small trees and matches near the root are searched on the calling thread only, see Bases::parallelTraverse.
+		// if multiple nodes match, any one of them may be returned.
+		template<typename TPred>
+		Node<T>* findIf(TPred pred, size_t thread_count = 0);
+
+		// calls func on the value of every node using thread_count threads (0 = hardware threads).
+		// the order is unspecified, and func must be safe to call from multiple threads at once.
+		template<typename TFunc>
+		void forEach(TFunc func, size_t thread_count = 0);
 	};
 	
 	// binary search tree node type
 	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
-	struct SNode: public NodeBase<T, SNode>
+	struct SNode: public Bases::NodeBase<T, SNode>
 	{
-		SNode(T val) : NodeBase<T, SNode>(val) {};
+		SNode(T val) : Bases::NodeBase<T, SNode>(val) {};
+
+		using Bases::NodeBase<T, SNode>::left;
+		using Bases::NodeBase<T, SNode>::right;
 
 		static SNode<T>* fromVector(const std::vector<T>& vec);
 
+		// builds a balanced search tree from vec using thread_count threads (0 = hardware threads).
+		// vec is sorted in parallel, after which the subtrees are built independently and linked to their parents.
+		static SNode<T>* fromVectorParallel(const std::vector<T>& vec, size_t thread_count = 0);
+
 		void insert(SNode<T>* val) { insert(val, this); }
 		void insert(SNode<T>* val, SNode<T>* node);
 		void insert(T val);
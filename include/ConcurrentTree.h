@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include <utility>
+
+namespace ADS
+{
+	/*
+	binary search tree supporting any number of concurrent readers alongside writers.
+
+	nodes are immutable once they have been published.
+	insert and remove copy the path from the root down to the modified node (copy-on-write),
+	and publish the new version of the tree with a single atomic store of the root pointer.
+	the tree is not rebalanced on writes, so every write copies O(depth) nodes, which degrades to O(n) for sorted inserts.
+	fromVector builds a balanced tree instead.
+	this means lookups and range scans never block, and always see a consistent version of the tree.
+	writers are serialized between each other by a mutex.
+
+	nodes replaced by a writer are retired instead of deleted.
+	a retired node is only deleted when every active reader started after it was retired (epoch based reclamation).
+
+	readers access the tree through a Snapshot, which pins the version of the tree it was created from.
+	pointers returned from a snapshot are valid for as long as the snapshot is alive.
+	the first MAX_READERS snapshots alive at the same time use a fixed array of slots.
+	any extra snapshot takes a slot from an overflow list, which grows when every slot in it is used as well,
+	so creating a snapshot never waits for other readers to finish.
+	*/
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	class CSTree
+	{
+	public:
+		static constexpr size_t MAX_READERS = 128;
+
+		// immutable node of the tree, shared between versions of the tree.
+		struct CNode
+		{
+			const T val;
+			const CNode* const left;
+			const CNode* const right;
+		};
+
+		// a pinned version of the tree.
+		// the nodes reachable from the snapshot are not deleted until the snapshot is destroyed.
+		class Snapshot
+		{
+			friend CSTree<T>;
+
+		public:
+			Snapshot(Snapshot&& other) noexcept;
+			Snapshot(const Snapshot&) = delete;
+			Snapshot& operator=(const Snapshot&) = delete;
+			Snapshot& operator=(Snapshot&&) = delete;
+			~Snapshot();
+
+			// returns a pointer to the value equal to val, or nullptr if it is not present in the snapshot.
+			const T* lookup(const T& val) const;
+			bool contains(const T& val) const { return lookup(val) != nullptr; }
+
+			// calls func on every value in the range [low, high] in sorted order.
+			template<typename TFunc>
+			void forEachInRange(const T& low, const T& high, TFunc func) const;
+
+			// calls func on every value in sorted order.
+			template<typename TFunc>
+			void forEach(TFunc func) const;
+
+			const CNode* root() const { return m_root; }
+
+		private:
+			Snapshot(const CSTree<T>* tree);
+
+			std::atomic<uint64_t>* m_slot;
+			const CNode* m_root;
+		};
+
+		CSTree() = default;
+		CSTree(const CSTree&) = delete;
+		CSTree& operator=(const CSTree&) = delete;
+		~CSTree();
+
+		// builds a balanced tree from a sorted copy of vec, without copying any path.
+		static CSTree<T>* fromVector(const std::vector<T>& vec);
+
+		// inserts val into the tree, equal values are placed to the left of each other like SNode.
+		// the tree is not rebalanced, so the path copied by every write is as long as the depth of the tree.
+		void insert(T val);
+
+		// removes a single instance of val from the tree.
+		// returns false if val was not present.
+		bool remove(const T& val);
+
+		// pins the current version of the tree.
+		// should be used instead of the convenience functions below, when multiple reads should see the same version.
+		Snapshot snapshot() const { return Snapshot(this); }
+
+		// returns a copy of the value equal to val, if present.
+		std::optional<T> lookup(const T& val) const;
+		bool contains(const T& val) const { return snapshot().contains(val); }
+
+		// calls func on every value in the range [low, high] in sorted order.
+		template<typename TFunc>
+		void forEachInRange(const T& low, const T& high, TFunc func) const { snapshot().forEachInRange(low, high, func); }
+
+		size_t size() const { return m_size.load(std::memory_order_relaxed); }
+
+		// deletes every retired node which can no longer be reached by any reader.
+		// is called automatically after every write.
+		void reclaim() { std::lock_guard<std::mutex> lock(m_write_mutex); reclaimRetired(); }
+
+	private:
+		// EPOCH DEFINITION:
+		// m_epoch is incremented after every publish, and starts at 1 since a reader slot of 0 marks the slot as unused.
+		// a reader stores the epoch it observed in a slot, before loading the root.
+		// nodes retired when the epoch was E, can be deleted once every used slot holds an epoch greater than E.
+
+		// prevents neighbouring reader slots from sharing a cache line.
+		struct alignas(64) ReaderSlot
+		{
+			std::atomic<uint64_t> epoch{ 0 };
+		};
+
+		// a slot allocated when every slot of m_readers is used.
+		// overflow slots are pushed to the front of m_overflow and never removed before the tree is destroyed, so the list can be walked without locking.
+		struct OverflowSlot : ReaderSlot
+		{
+			OverflowSlot* next = nullptr;
+		};
+
+		std::atomic<const CNode*> m_root{ nullptr };
+		std::atomic<uint64_t> m_epoch{ 1 };
+		std::atomic<size_t> m_size{ 0 };
+
+		mutable std::array<ReaderSlot, MAX_READERS> m_readers;
+		mutable std::atomic<OverflowSlot*> m_overflow{ nullptr };
+
+		std::mutex m_write_mutex;
+		std::vector<std::pair<uint64_t, const CNode*>> m_retired;
+
+		// marks a free reader slot with the current epoch, and returns it.
+		// the root must be loaded after the slot is marked, otherwise a writer could reclaim the root in between.
+		std::atomic<uint64_t>& pinSlot() const;
+
+		// publishes new_root and retires the passed nodes.
+		// must be called while holding m_write_mutex.
+		void publish(const CNode* new_root, const std::vector<const CNode*>& replaced);
+
+		// must be called while holding m_write_mutex.
+		void reclaimRetired();
+
+		// a node on the path from the root, and wether the path continues to its right child.
+		using PathStep = std::pair<const CNode*, bool>;
+
+		// rebuilds the path (root first) bottom up, with the child the path continues to from the last node replaced by child.
+		// every node in path is appended to replaced.
+		// returns the new root.
+		static const CNode* copyPath(const std::vector<PathStep>& path, const CNode* child, std::vector<const CNode*>& replaced);
+
+		// builds a balanced tree from the sorted range [begin, end).
+		static const CNode* buildBalanced(const T* begin, const T* end);
+
+		static void deleteTree(const CNode* root);
+	};
+}
+
+#include "ConcurrentTree.ipp"
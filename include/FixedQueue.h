@@ -44,7 +44,7 @@ namespace ADS
 		{
 		public:
 			FixedQueueBase(T* data, size_t size)
-				: m_data(data), m_fixed_size(size) {}
+				: m_fixed_size(size), m_data(data) {}
 
 			T& front() { return m_data[m_front_index]; }
 			T front() const { return m_data[m_front_index]; }
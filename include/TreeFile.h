@@ -0,0 +1,163 @@
+#pragma once
+
+#include "BinaryTree.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace ADS
+{
+	namespace Bases
+	{
+		// TREE FILE DEFINITION:
+		// nodes are stored as fixed size records in postorder, followed by a footer.
+		// FILE = RECORD... + FOOTER
+		// RECORD = VAL + PADDING + LINK + PADDING
+		// in postorder the right child of a node is always the record right before it, so it only needs a flag,
+		// which is the highest bit of LINK. the remaining bits store the index of the left child + 1, or 0 if there is no left child.
+		// LINK is 32 bits wide if every index fits, and 64 bits otherwise, so a tree of ints takes 8 bytes per node.
+		// the root is the last record.
+		// values and indices are stored in the byte order of the machine writing the file, which is checked on load.
+		// every field of a record is aligned, so values can be read directly from the mapped file.
+
+		constexpr uint32_t TREE_FILE_VERSION = 2;
+		constexpr uint32_t TREE_FILE_BYTE_ORDER = 0x01020304;
+
+		struct TreeFileFooter
+		{
+			char magic[4] = { 'A', 'D', 'S', 'T' };
+			uint32_t version = TREE_FILE_VERSION;
+			uint32_t byte_order = TREE_FILE_BYTE_ORDER;
+			uint32_t value_size = 0;
+			uint32_t link_size = 0;
+			uint32_t record_size = 0;
+			uint64_t node_count = 0;
+		};
+
+		// layout of a single record for the value type T, with a link of type TLink.
+		template<typename T, typename TLink>
+		struct TreeFileRecord
+		{
+			using Link = TLink;
+
+			static constexpr size_t ALIGN = alignof(T) > alignof(TLink) ? alignof(T) : alignof(TLink);
+
+			static constexpr size_t LINK_OFFSET = (sizeof(T) + alignof(TLink) - 1) / alignof(TLink) * alignof(TLink);
+			static constexpr size_t SIZE = (LINK_OFFSET + sizeof(TLink) + ALIGN - 1) / ALIGN * ALIGN;
+
+			static constexpr TLink RIGHT = TLink(1) << (sizeof(TLink) * 8 - 1);
+			// the largest node count where every left index + 1 fits below the right flag.
+			static constexpr uint64_t MAX_NODES = RIGHT - 1;
+		};
+	}
+
+	namespace Bases
+	{
+		// read only memory mapping of a whole file.
+		// defined in TreeFile.cpp, so the platform headers are not included by every user of TreeFile.h.
+		class MappedFile
+		{
+		public:
+			MappedFile() = default;
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+			~MappedFile() { close(); }
+
+			// maps the file at path.
+			// returns false if the file could not be mapped, or if it is empty.
+			bool open(const std::string& path);
+			void close();
+
+			const uint8_t* data() const { return m_data; }
+			size_t size() const { return m_size; }
+
+		private:
+			const uint8_t* m_data = nullptr;
+			size_t m_size = 0;
+
+#ifdef _WIN32
+			void* m_file = nullptr;
+			void* m_mapping = nullptr;
+#endif
+		};
+	}
+
+	// writes the tree from root to the stream in the tree file format, without seeking.
+	// the nodes are counted before writing to pick the width of the links.
+	// the tree is traversed iteratively, so degenerate trees of any depth can be written.
+	// returns false if the stream failed.
+	template<typename T, template<typename> class TNode> requires std::is_trivially_copyable_v<T>
+	bool writeTree(std::ostream& stream, const Bases::NodeBase<T, TNode>* root);
+
+	// read only view of a tree file, which is memory mapped instead of read.
+	// the mapping is done by Bases::MappedFile, so TreeFile.cpp must be compiled along with the code using it.
+	// lookups are served directly from the mapped bytes, without creating any node objects.
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	class MappedTree
+	{
+	public:
+		MappedTree() = default;
+		MappedTree(const std::string& path) { open(path); }
+		MappedTree(const MappedTree&) = delete;
+		MappedTree& operator=(const MappedTree&) = delete;
+		~MappedTree() { close(); }
+
+		// maps the file at path.
+		// returns false if the file could not be mapped, or if it is not a tree file storing values of type T.
+		bool open(const std::string& path);
+		void close();
+
+		bool isOpen() const { return m_data != nullptr; }
+
+		// returns the number of nodes stored.
+		size_t size() const { return m_node_count; }
+
+		// searches the tree as a binary search tree, so the file must have been written from an SNode.
+		// returns a pointer into the mapped file, or nullptr if val was not found or the search reached an invalid child index.
+		const T* lookup(const T& val) const;
+
+		// searches every node, so it works for any tree.
+		const T* find(const T& val) const;
+		template<typename TPred>
+		const T* findIf(TPred pred) const;
+
+		// creates node objects for the whole tree.
+		// returns nullptr if the links of the records do not describe a single tree.
+		template<template<typename> class TNode>
+		TNode<T>* toTree() const;
+
+	private:
+		using Record32 = Bases::TreeFileRecord<T, uint32_t>;
+		using Record64 = Bases::TreeFileRecord<T, uint64_t>;
+
+		Bases::MappedFile m_file;
+		const uint8_t* m_data = nullptr;
+		size_t m_node_count = 0;
+		size_t m_record_size = 0;
+		bool m_wide_links = false;
+
+		const T* value(size_t index) const { return (const T*)(m_data + index * m_record_size); }
+
+		// returns whether the node has a right child, which is always the record at index - 1.
+		bool hasRight(size_t index) const
+		{
+			return m_wide_links ? link<Record64>(index) & Record64::RIGHT : link<Record32>(index) & Record32::RIGHT;
+		}
+
+		// returns the index of the left child + 1, or 0 if the node has no left child.
+		uint64_t leftLink(size_t index) const
+		{
+			return m_wide_links ? link<Record64>(index) & ~Record64::RIGHT : link<Record32>(index) & ~Record32::RIGHT;
+		}
+
+		template<typename TRecord>
+		typename TRecord::Link link(size_t index) const
+		{
+			return *(const typename TRecord::Link*)(m_data + index * m_record_size + TRecord::LINK_OFFSET);
+		}
+	};
+}
+
+#include "TreeFile.ipp"
@@ -0,0 +1,144 @@
+#include "ArenaStats.h"
+
+#include <sstream>
+
+namespace ADS
+{
+    uint64_t ArenaHistogram::percentile(double p) const
+    {
+        if (count == 0) return 0;
+
+        // number of values at or below the percentile, rounded up so p = 1 always reaches the last value.
+        uint64_t target = (uint64_t)(p * count + 0.999999);
+        uint64_t seen = 0;
+
+        for (size_t i = 0; i < BUCKETS; i++)
+        {
+            seen += buckets[i];
+
+            if (seen >= target && seen > 0)
+                return upperBound(i) < max ? upperBound(i) : max;
+        }
+
+        return max;
+    }
+
+    // writes the histogram as a json object, only containing the non empty buckets.
+    static void histogramJson(std::ostream& stream, const ArenaHistogram& histogram)
+    {
+        stream << "{\"count\":" << histogram.count
+            << ",\"sum\":" << histogram.sum
+            << ",\"max\":" << histogram.max
+            << ",\"p50\":" << histogram.percentile(0.5)
+            << ",\"p99\":" << histogram.percentile(0.99)
+            << ",\"buckets\":[";
+
+        bool first = true;
+
+        for (size_t i = 0; i < ArenaHistogram::BUCKETS; i++)
+        {
+            if (histogram.buckets[i] == 0) continue;
+
+            if (!first) stream << ',';
+            first = false;
+
+            stream << "{\"le\":" << ArenaHistogram::upperBound(i) << ",\"count\":" << histogram.buckets[i] << '}';
+        }
+
+        stream << "]}";
+    }
+
+    // writes the histogram as a prometheus histogram, with cumulative buckets up to the last non empty one.
+    static void histogramPrometheus(std::ostream& stream, const std::string& name, const std::string& help, const ArenaHistogram& histogram)
+    {
+        stream << "# HELP " << name << ' ' << help << '\n';
+        stream << "# TYPE " << name << " histogram\n";
+
+        size_t last = 0;
+
+        for (size_t i = 0; i < ArenaHistogram::BUCKETS; i++)
+            if (histogram.buckets[i] > 0)
+                last = i;
+
+        uint64_t cumulative = 0;
+
+        for (size_t i = 0; i <= last; i++)
+        {
+            cumulative += histogram.buckets[i];
+            stream << name << "_bucket{le=\"" << ArenaHistogram::upperBound(i) << "\"} " << cumulative << '\n';
+        }
+
+        stream << name << "_bucket{le=\"+Inf\"} " << histogram.count << '\n';
+        stream << name << "_sum " << histogram.sum << '\n';
+        stream << name << "_count " << histogram.count << '\n';
+    }
+
+    template<typename TValue>
+    static void gaugePrometheus(std::ostream& stream, const std::string& name, const std::string& type, const std::string& help, TValue value)
+    {
+        stream << "# HELP " << name << ' ' << help << '\n';
+        stream << "# TYPE " << name << ' ' << type << '\n';
+        stream << name << ' ' << value << '\n';
+    }
+
+    std::string ArenaStatsSnapshot::toJson() const
+    {
+        std::ostringstream stream;
+
+        stream << "{\"arena_bytes\":" << arena_bytes
+            << ",\"live_bytes\":" << live_bytes
+            << ",\"live_blocks\":" << live_blocks
+            << ",\"free_bytes\":" << free_bytes
+            << ",\"largest_free_extent\":" << largest_free_extent
+            << ",\"fragmentation\":" << fragmentation
+            << ",\"counters_enabled\":" << (counters_enabled ? "true" : "false");
+
+        if (counters_enabled)
+        {
+            stream << ",\"high_water_bytes\":" << high_water_bytes
+                << ",\"allocs\":" << allocs
+                << ",\"frees\":" << frees
+                << ",\"failed_allocs\":" << failed_allocs;
+
+            stream << ",\"alloc_sizes\":";
+            histogramJson(stream, alloc_sizes);
+            stream << ",\"free_sizes\":";
+            histogramJson(stream, free_sizes);
+            stream << ",\"alloc_latency_ns\":";
+            histogramJson(stream, alloc_latency_ns);
+            stream << ",\"free_latency_ns\":";
+            histogramJson(stream, free_latency_ns);
+        }
+
+        stream << '}';
+
+        return stream.str();
+    }
+
+    std::string ArenaStatsSnapshot::toPrometheus(const std::string& prefix) const
+    {
+        std::ostringstream stream;
+
+        gaugePrometheus(stream, prefix + "_size_bytes", "gauge", "total size of the arena in bytes.", arena_bytes);
+        gaugePrometheus(stream, prefix + "_live_bytes", "gauge", "bytes currently allocated from the arena.", live_bytes);
+        gaugePrometheus(stream, prefix + "_live_blocks", "gauge", "memory blocks currently allocated from the arena.", live_blocks);
+        gaugePrometheus(stream, prefix + "_free_bytes", "gauge", "bytes not used by any memory block.", free_bytes);
+        gaugePrometheus(stream, prefix + "_largest_free_extent_bytes", "gauge", "size of the largest contiguous free extent in bytes.", largest_free_extent);
+        gaugePrometheus(stream, prefix + "_fragmentation_ratio", "gauge", "1 - largest free extent / free bytes.", fragmentation);
+
+        if (counters_enabled)
+        {
+            gaugePrometheus(stream, prefix + "_high_water_bytes", "gauge", "largest number of bytes allocated at once.", high_water_bytes);
+            gaugePrometheus(stream, prefix + "_allocs_total", "counter", "successful allocations.", allocs);
+            gaugePrometheus(stream, prefix + "_frees_total", "counter", "frees.", frees);
+            gaugePrometheus(stream, prefix + "_failed_allocs_total", "counter", "allocations which did not fit in the arena.", failed_allocs);
+
+            histogramPrometheus(stream, prefix + "_alloc_size_bytes", "size of successful allocations.", alloc_sizes);
+            histogramPrometheus(stream, prefix + "_free_size_bytes", "size of freed memory blocks.", free_sizes);
+            histogramPrometheus(stream, prefix + "_alloc_latency_nanoseconds", "latency of allocations.", alloc_latency_ns);
+            histogramPrometheus(stream, prefix + "_free_latency_nanoseconds", "latency of frees.", free_latency_ns);
+        }
+
+        return stream.str();
+    }
+}
@@ -3,6 +3,10 @@
 #include "BinaryTree.h"
 
 #include <stack>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <algorithm>
 
 namespace ADS
 {
@@ -33,6 +37,149 @@ namespace ADS
 			toStringHelper(str, padding, pointerLeft, node->left);
 			toStringHelper(str, padding, pointerRight, node->right);
 		}
+
+		// definition of the work stealing traversal
+
+		template<typename TNode, typename TVisit>
+		void parallelTraverse(TNode* root, TVisit visit, size_t thread_count)
+		{
+			if (!root) return;
+
+			std::vector<TNode*> serial = { root };
+
+			for (size_t visited = 0; !serial.empty() && (thread_count == 1 || visited < PARALLEL_TRAVERSE_SERIAL_NODES); visited++)
+			{
+				TNode* node = serial.back();
+				serial.pop_back();
+
+				if (visit(node))
+					return;
+
+				if (node->right)
+					serial.push_back(node->right);
+
+				if (node->left)
+					serial.push_back(node->left);
+			}
+
+			if (serial.empty())
+				return;
+
+			// nodes which can be stolen by other threads.
+			// padded to prevent neighbouring queues from sharing a cache line.
+			struct alignas(64) WorkQueue
+			{
+				std::mutex mutex;
+				std::deque<TNode*> nodes;
+				std::atomic<size_t> size{ 0 };
+			};
+
+			std::vector<WorkQueue> queues(thread_count);
+			// number of nodes which have been found but not visited yet, either queued or on the serial stack of a thread.
+			// a node is only subtracted after its children have been added, so it can only reach 0 once every node has been visited.
+			std::atomic<size_t> pending = serial.size();
+			std::atomic<bool> stop = false;
+
+			// the nodes left over from the serial part are dealt out, so every thread has work from the start.
+			for (size_t i = 0; i < serial.size(); i++)
+				queues[i % thread_count].nodes.push_back(serial[i]);
+
+			for (WorkQueue& queue : queues)
+				queue.size = queue.nodes.size();
+
+			// pops a node from the queue.
+			auto take = [&](WorkQueue& queue, bool steal) -> TNode*
+			{
+				if (queue.size.load(std::memory_order_relaxed) == 0)
+					return nullptr;
+
+				std::lock_guard<std::mutex> lock(queue.mutex);
+
+				if (queue.nodes.empty())
+					return nullptr;
+
+				// the owner takes the most recently donated node, while thieves take the oldest one, which is likely the largest subtree.
+				TNode* node = steal ? queue.nodes.front() : queue.nodes.back();
+
+				if (steal)
+					queue.nodes.pop_front();
+				else
+					queue.nodes.pop_back();
+
+				queue.size.store(queue.nodes.size(), std::memory_order_relaxed);
+
+				return node;
+			};
+
+			auto worker = [&](size_t id)
+			{
+				WorkQueue& own = queues[id];
+				std::vector<TNode*> local;
+
+				while (!stop.load(std::memory_order_relaxed))
+				{
+					TNode* start = take(own, false);
+
+					for (size_t i = 1; !start && i < thread_count; i++)
+						start = take(queues[(id + i) % thread_count], true);
+
+					if (!start)
+					{
+						if (pending == 0)
+							return;
+
+						std::this_thread::yield();
+						continue;
+					}
+
+					local.push_back(start);
+
+					while (!local.empty() && !stop.load(std::memory_order_relaxed))
+					{
+						TNode* node = local.back();
+						local.pop_back();
+
+						if (visit(node))
+							stop = true;
+
+						if (node->right)
+							local.push_back(node->right);
+
+						if (node->left)
+							local.push_back(node->left);
+
+						size_t children = (node->left ? 1 : 0) + (node->right ? 1 : 0);
+
+						if (children > 0)
+							pending += children;
+
+						pending--;
+
+						// the queue has been emptied by other threads, so hand out the oldest node on the local stack.
+						if (local.size() > 1 && own.size.load(std::memory_order_relaxed) == 0)
+						{
+							std::lock_guard<std::mutex> lock(own.mutex);
+							own.nodes.push_back(local.front());
+							own.size.store(own.nodes.size(), std::memory_order_relaxed);
+							local.erase(local.begin());
+						}
+					}
+
+					local.clear();
+				}
+			};
+
+			std::vector<std::thread> threads;
+			threads.reserve(thread_count - 1);
+
+			for (size_t i = 1; i < thread_count; i++)
+				threads.emplace_back(worker, i);
+
+			worker(0);
+
+			for (std::thread& thread : threads)
+				thread.join();
+		}
 	}
 
 	// standard binary tree node definitions
@@ -88,21 +235,48 @@ namespace ADS
 			
 			node_stack.pop();
 			
-			if (tmp->left->val == val)
-				return tmp->left;
-			else if (tmp->right->val == val)
-				return tmp->right;
+			if (tmp->val == val)
+				return tmp;
 
 			if (tmp->left)
-				node_stack->push(tmp->left);
+				node_stack.push(tmp->left);
 
 			if (tmp->right)
-				node_stack->push(tmp->right);
+				node_stack.push(tmp->right);
 		}
 
 		return nullptr;
 	}
 
+	template<typename T>
+	template<typename TPred>
+	Node<T>* Node<T>::findIf(TPred pred, size_t thread_count)
+	{
+		std::atomic<Node<T>*> result = nullptr;
+
+		Bases::parallelTraverse(this, [&](Node<T>* node)
+			{
+				if (!pred(node->val))
+					return false;
+
+				result = node;
+				return true;
+			}, Bases::threadCount(thread_count));
+
+		return result;
+	}
+
+	template<typename T>
+	template<typename TFunc>
+	void Node<T>::forEach(TFunc func, size_t thread_count)
+	{
+		Bases::parallelTraverse(this, [&](Node<T>* node)
+			{
+				func(node->val);
+				return false;
+			}, Bases::threadCount(thread_count));
+	}
+
 	// binary search tree definitions
 	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
 	SNode<T>* SNode<T>::fromVector(const std::vector<T>& vec)
@@ -115,6 +289,80 @@ namespace ADS
 		return head;
 	}
 
+	namespace Bases
+	{
+		// builds a balanced search tree from the sorted range [begin, end), building the two subtrees on separate threads while thread_count > 1.
+		template<typename T>
+		SNode<T>* buildBalanced(const T* begin, const T* end, size_t thread_count)
+		{
+			if (begin == end) return nullptr;
+
+			// always split at the midpoint, so the depth stays logarithmic even when most values are equal.
+			// equal values can end up on both sides of a node, which keeps the tree sorted in order, and lookup stops at the first equal node.
+			const T* mid = begin + (end - begin) / 2;
+
+			SNode<T>* node = new SNode<T>(*mid);
+
+			if (thread_count > 1)
+			{
+				std::thread left_thread([&]() { node->left = buildBalanced(begin, mid, thread_count / 2); });
+				node->right = buildBalanced(mid + 1, end, thread_count - thread_count / 2);
+				left_thread.join();
+			}
+			else
+			{
+				node->left = buildBalanced(begin, mid, 1);
+				node->right = buildBalanced(mid + 1, end, 1);
+			}
+
+			return node;
+		}
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	SNode<T>* SNode<T>::fromVectorParallel(const std::vector<T>& vec, size_t thread_count)
+	{
+		if (vec.empty()) return nullptr;
+
+		thread_count = std::min(Bases::threadCount(thread_count), vec.size());
+
+		std::vector<T> sorted = vec;
+
+		// sort thread_count chunks independently
+		std::vector<size_t> bounds(thread_count + 1);
+
+		for (size_t i = 0; i <= thread_count; i++)
+			bounds[i] = sorted.size() * i / thread_count;
+
+		std::vector<std::thread> threads;
+
+		for (size_t i = 0; i < thread_count; i++)
+			threads.emplace_back([&, i]() { std::sort(sorted.begin() + bounds[i], sorted.begin() + bounds[i + 1]); });
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		// merge neighbouring chunks in parallel, until a single sorted chunk is left
+		for (size_t width = 1; width < thread_count; width *= 2)
+		{
+			threads.clear();
+
+			for (size_t i = 0; i + width < thread_count; i += width * 2)
+			{
+				auto first = sorted.begin() + bounds[i];
+				auto middle = sorted.begin() + bounds[i + width];
+				auto last = sorted.begin() + bounds[std::min(i + width * 2, thread_count)];
+
+				threads.emplace_back([=]() { std::inplace_merge(first, middle, last); });
+			}
+
+			for (std::thread& thread : threads)
+				thread.join();
+		}
+
+		return Bases::buildBalanced(sorted.data(), sorted.data() + sorted.size(), thread_count);
+	}
+
 	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
 	void SNode<T>::insert(SNode<T>* new_node, SNode<T>* node)
 	{
@@ -0,0 +1,365 @@
+#pragma once
+
+#include "ConcurrentTree.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stack>
+#include <thread>
+
+namespace ADS
+{
+	// Snapshot definitions
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	CSTree<T>::Snapshot::Snapshot(const CSTree<T>* tree)
+		: m_slot(&tree->pinSlot()), m_root(tree->m_root.load())
+	{
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	CSTree<T>::Snapshot::Snapshot(Snapshot&& other) noexcept
+		: m_slot(other.m_slot), m_root(other.m_root)
+	{
+		other.m_slot = nullptr;
+		other.m_root = nullptr;
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	CSTree<T>::Snapshot::~Snapshot()
+	{
+		if (m_slot)
+			m_slot->store(0);
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	const T* CSTree<T>::Snapshot::lookup(const T& val) const
+	{
+		const CNode* tmp = m_root;
+
+		while (tmp)
+		{
+			if (tmp->val == val)
+				return &tmp->val;
+			else if (tmp->val >= val)
+				tmp = tmp->left;
+			else
+				tmp = tmp->right;
+		}
+
+		return nullptr;
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	template<typename TFunc>
+	void CSTree<T>::Snapshot::forEachInRange(const T& low, const T& high, TFunc func) const
+	{
+		std::stack<const CNode*> node_stack;
+		const CNode* tmp = m_root;
+
+		// iterative in order traversal, skipping subtrees which are entirely outside the range.
+		while (tmp || !node_stack.empty())
+		{
+			while (tmp)
+			{
+				node_stack.push(tmp);
+				// values equal to low can be stored in the left subtree.
+				tmp = tmp->val >= low ? tmp->left : nullptr;
+			}
+
+			tmp = node_stack.top();
+			node_stack.pop();
+
+			if (tmp->val > high)
+				return;
+
+			if (tmp->val >= low)
+				func(tmp->val);
+
+			tmp = tmp->right;
+		}
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	template<typename TFunc>
+	void CSTree<T>::Snapshot::forEach(TFunc func) const
+	{
+		std::stack<const CNode*> node_stack;
+		const CNode* tmp = m_root;
+
+		while (tmp || !node_stack.empty())
+		{
+			while (tmp)
+			{
+				node_stack.push(tmp);
+				tmp = tmp->left;
+			}
+
+			tmp = node_stack.top();
+			node_stack.pop();
+
+			func(tmp->val);
+
+			tmp = tmp->right;
+		}
+	}
+
+	// CSTree definitions
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	CSTree<T>::~CSTree()
+	{
+		// no readers can be active at this point, so every node can be deleted.
+		deleteTree(m_root.load());
+
+		for (auto& [epoch, node] : m_retired)
+			delete node;
+
+		for (OverflowSlot* slot = m_overflow.load(); slot;)
+		{
+			OverflowSlot* next = slot->next;
+			delete slot;
+			slot = next;
+		}
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	CSTree<T>* CSTree<T>::fromVector(const std::vector<T>& vec)
+	{
+		std::vector<T> sorted = vec;
+		std::sort(sorted.begin(), sorted.end());
+
+		// no reader can access the tree yet, so the whole tree is published with a single store.
+		CSTree<T>* tree = new CSTree<T>();
+		tree->m_root.store(buildBalanced(sorted.data(), sorted.data() + sorted.size()));
+		tree->m_size.store(sorted.size());
+
+		return tree;
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	const typename CSTree<T>::CNode* CSTree<T>::buildBalanced(const T* begin, const T* end)
+	{
+		if (begin == end)
+			return nullptr;
+
+		// same split as Bases::buildBalanced, equal values may end up on both sides of mid, which lookup and remove handle.
+		const T* mid = begin + (end - begin) / 2;
+
+		// nodes are immutable, so both subtrees are built before their parent.
+		const CNode* left = buildBalanced(begin, mid);
+		const CNode* right = buildBalanced(mid + 1, end);
+
+		return new CNode{ *mid, left, right };
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	void CSTree<T>::insert(T val)
+	{
+		std::lock_guard<std::mutex> lock(m_write_mutex);
+
+		std::vector<PathStep> path;
+		std::vector<const CNode*> replaced;
+
+		for (const CNode* tmp = m_root.load(std::memory_order_relaxed); tmp;)
+		{
+			bool right = val > tmp->val;
+			path.push_back({ tmp, right });
+			tmp = right ? tmp->right : tmp->left;
+		}
+
+		const CNode* leaf = new CNode{ val, nullptr, nullptr };
+
+		publish(copyPath(path, leaf, replaced), replaced);
+		m_size.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	bool CSTree<T>::remove(const T& val)
+	{
+		std::lock_guard<std::mutex> lock(m_write_mutex);
+
+		std::vector<PathStep> path;
+		std::vector<const CNode*> replaced;
+
+		const CNode* target = m_root.load(std::memory_order_relaxed);
+
+		// same search order as lookup
+		while (target && !(target->val == val))
+		{
+			bool right = !(target->val >= val);
+			path.push_back({ target, right });
+			target = right ? target->right : target->left;
+		}
+
+		if (!target)
+			return false;
+
+		replaced.push_back(target);
+
+		const CNode* replacement;
+
+		if (!target->left)
+			replacement = target->right;
+		else if (!target->right)
+			replacement = target->left;
+		else
+		{
+			// replace the target with the minimum of its right subtree,
+			// which is removed by copying the path from the right child down to it.
+			std::vector<PathStep> min_path;
+			const CNode* min = target->right;
+
+			while (min->left)
+			{
+				min_path.push_back({ min, false });
+				min = min->left;
+			}
+
+			replaced.push_back(min);
+
+			const CNode* new_right = min_path.empty() ? min->right : copyPath(min_path, min->right, replaced);
+
+			replacement = new CNode{ min->val, target->left, new_right };
+		}
+
+		publish(copyPath(path, replacement, replaced), replaced);
+		m_size.fetch_sub(1, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	std::optional<T> CSTree<T>::lookup(const T& val) const
+	{
+		Snapshot snap = snapshot();
+		const T* result = snap.lookup(val);
+
+		if (result)
+			return *result;
+
+		return std::nullopt;
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	std::atomic<uint64_t>& CSTree<T>::pinSlot() const
+	{
+		auto tryPin = [&](std::atomic<uint64_t>& slot)
+		{
+			uint64_t expected = 0;
+			return slot.load(std::memory_order_relaxed) == 0 && slot.compare_exchange_strong(expected, m_epoch.load());
+		};
+
+		// start probing at a slot depending on the thread, so threads rarely compete for the same slot.
+		size_t start = std::hash<std::thread::id>{}(std::this_thread::get_id()) % MAX_READERS;
+
+		for (size_t i = 0; i < MAX_READERS; i++)
+		{
+			std::atomic<uint64_t>& slot = m_readers[(start + i) % MAX_READERS].epoch;
+
+			if (tryPin(slot))
+				return slot;
+		}
+
+		for (OverflowSlot* slot = m_overflow.load(); slot; slot = slot->next)
+			if (tryPin(slot->epoch))
+				return slot->epoch;
+
+		// every slot is used, so a new one is added, which is already marked when it becomes visible to writers.
+		OverflowSlot* slot = new OverflowSlot();
+		slot->epoch.store(m_epoch.load());
+		slot->next = m_overflow.load();
+
+		while (!m_overflow.compare_exchange_weak(slot->next, slot));
+
+		return slot->epoch;
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	void CSTree<T>::publish(const CNode* new_root, const std::vector<const CNode*>& replaced)
+	{
+		m_root.store(new_root);
+
+		// readers pinning the epoch after this increment can only load the new root.
+		uint64_t epoch = m_epoch.fetch_add(1);
+
+		for (const CNode* node : replaced)
+			m_retired.push_back({ epoch, node });
+
+		reclaimRetired();
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	void CSTree<T>::reclaimRetired()
+	{
+		if (m_retired.empty())
+			return;
+
+		uint64_t min_epoch = std::numeric_limits<uint64_t>::max();
+
+		auto visit = [&](const ReaderSlot& slot)
+		{
+			uint64_t epoch = slot.epoch.load();
+
+			if (epoch != 0 && epoch < min_epoch)
+				min_epoch = epoch;
+		};
+
+		for (const ReaderSlot& slot : m_readers)
+			visit(slot);
+
+		for (const OverflowSlot* slot = m_overflow.load(); slot; slot = slot->next)
+			visit(*slot);
+
+		// m_retired is sorted by epoch, since the epoch only ever increases.
+		size_t reclaimed = 0;
+
+		while (reclaimed < m_retired.size() && m_retired[reclaimed].first < min_epoch)
+		{
+			delete m_retired[reclaimed].second;
+			reclaimed++;
+		}
+
+		m_retired.erase(m_retired.begin(), m_retired.begin() + reclaimed);
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	const typename CSTree<T>::CNode* CSTree<T>::copyPath(const std::vector<PathStep>& path, const CNode* child, std::vector<const CNode*>& replaced)
+	{
+		for (auto it = path.rbegin(); it != path.rend(); it++)
+		{
+			auto [node, right] = *it;
+
+			child = right ? new CNode{ node->val, node->left, child } : new CNode{ node->val, child, node->right };
+
+			replaced.push_back(node);
+		}
+
+		return child;
+	}
+
+	template<typename T> requires requires(T x) { x < x <= x == x != x >= x > x; }
+	void CSTree<T>::deleteTree(const CNode* root)
+	{
+		// iterative, since an unbalanced tree can be far deeper than the call stack allows.
+		std::stack<const CNode*> node_stack;
+
+		if (root)
+			node_stack.push(root);
+
+		while (!node_stack.empty())
+		{
+			const CNode* tmp = node_stack.top();
+			node_stack.pop();
+
+			if (tmp->left)
+				node_stack.push(tmp->left);
+
+			if (tmp->right)
+				node_stack.push(tmp->right);
+
+			delete tmp;
+		}
+	}
+}
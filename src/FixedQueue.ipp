@@ -2,7 +2,6 @@
 #include <cassert>
 #include <numeric>
 #include <limits>
-#include "..\include\FixedQueue.h"
 
 
 namespace ADS
@@ -13,31 +13,73 @@ namespace ADS
 
     void ModArena::free(ArenaPtr<void> ptr)
     {
-        assert(std::find(m_mem_info.begin(), m_mem_info.end(), *ptr.blockInfo()) != m_mem_info.end());
+        ArenaStats::Timer timer;
+
+        auto info = std::find_if(m_mem_info.begin(), m_mem_info.end(), [&](const MemBlockInfo& other) { return &other == ptr.blockInfo(); });
+
+        assert(info != m_mem_info.end());
+
+        size_t block_size = info->size();
+
+        // keep the unused memory zero initialized
+        memset(info->start, 0, block_size);
+        m_mem_info.erase(info);
+
+        m_stats.onFree(block_size, timer.elapsed());
+
         ptr.m_mem_info = nullptr;
         ptr.m_pos = nullptr;
     }
 
-    std::pair<byte*, size_t> ModArena::findFreeAddress(size_t size)
+    std::pair<byte*, std::list<MemBlockInfo>::iterator> ModArena::findFreeAddress(size_t size)
     {
 
         byte* last = m_arena;
-        size_t index = 0;
 
-        for (const MemBlockInfo& info : m_mem_info)
+        for (auto info = m_mem_info.begin(); info != m_mem_info.end(); info++)
         {
-            if (size_t(last - info.start) >= size)
-                return { last, index };
+            if (size_t(info->start - last) >= size)
+                return { last, info };
             else
-            {
-                last = info.end;
-                index++;
-            }
+                last = info->end;
         }
 
         // compare to end of arena instead of memory block infront of last
-        if (last - m_arena + m_arena_size >= size) return { last, index };
+        if (size_t(m_arena + m_arena_size - last) >= size) return { last, m_mem_info.end() };
+
+        return { nullptr, m_mem_info.end() };
+    }
+
+    ArenaStatsSnapshot ModArena::stats() const
+    {
+        ArenaStatsSnapshot snapshot;
+        snapshot.arena_bytes = m_arena_size;
+
+        const byte* last = m_arena;
+
+        auto addExtent = [&](size_t extent)
+        {
+            snapshot.free_bytes += extent;
+            snapshot.largest_free_extent = std::max(snapshot.largest_free_extent, extent);
+        };
+
+        for (const MemBlockInfo& info : m_mem_info)
+        {
+            addExtent(size_t(info.start - last));
+
+            snapshot.live_blocks++;
+            snapshot.live_bytes += size_t(info.end - info.start);
+
+            last = info.end;
+        }
+
+        addExtent(size_t(m_arena + m_arena_size - last));
+
+        if (snapshot.free_bytes > 0)
+            snapshot.fragmentation = 1.0 - (double) snapshot.largest_free_extent / (double) snapshot.free_bytes;
+
+        m_stats.fill(snapshot);
 
-        return { nullptr, NULL };
+        return snapshot;
     }
 };
@@ -7,11 +7,20 @@ namespace ADS
     ArenaPtr<T> ModArena::alloc(size_t amount)
     {
         assert(amount > 0);
-        auto[address, index] = findFreeAddress(amount * sizeof(T));
+        ArenaStats::Timer timer;
 
-        if(!address) return {};
+        auto[address, position] = findFreeAddress(amount * sizeof(T));
 
-        m_mem_info.insert(m_mem_info.begin() + index, MemBlockInfo{address, address + amount * sizeof(T)});
-        return &m_mem_info[index];
+        if(!address)
+        {
+            m_stats.onAlloc(amount * sizeof(T), timer.elapsed(), false);
+            return {};
+        }
+
+        auto info = m_mem_info.insert(position, MemBlockInfo{address, address + amount * sizeof(T)});
+
+        m_stats.onAlloc(amount * sizeof(T), timer.elapsed(), true);
+
+        return &*info;
     }
 }
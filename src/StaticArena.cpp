@@ -5,7 +5,7 @@ namespace ADS
     StaticArena::StaticArena(size_t arena_size)
         : m_arena(new byte[arena_size]), m_arena_size(arena_size)
     {
-        memset(m_arena, NULL, m_arena_size);
+        memset(m_arena, 0, m_arena_size);
     }
 
 
@@ -13,9 +13,14 @@ namespace ADS
     {
         assert(isValid((byte*) address));
 
+        ArenaStats::Timer timer;
+
         size_t block_size = ptrSize((byte*) address);
 
-        memset((byte*) address - sizeof(size_t), NULL, block_size + 1);
+        // clear both the block size and the data, so the unused memory stays zero initialized.
+        memset((byte*) address - sizeof(size_t), 0, blockSpan(block_size) + sizeof(size_t));
+
+        m_stats.onFree(block_size, timer.elapsed());
 
         address = nullptr;
     }
@@ -25,6 +30,54 @@ namespace ADS
         m_arena_size = new_size;
         delete[] m_arena;
         m_arena = new byte[m_arena_size];
+        memset(m_arena, 0, m_arena_size);
+
+        m_stats.onClear();
+    }
+
+    ArenaStatsSnapshot StaticArena::stats() const
+    {
+        ArenaStatsSnapshot snapshot;
+        snapshot.arena_bytes = m_arena_size;
+
+        const byte* end = m_arena + m_arena_size;
+        // end of the last allocated memory block
+        const byte* last = m_arena;
+
+        auto addExtent = [&](size_t extent)
+        {
+            snapshot.free_bytes += extent;
+            snapshot.largest_free_extent = std::max(snapshot.largest_free_extent, extent);
+        };
+
+        // same walk as findFreeAddress, unused memory reads as blocks of size 0.
+        for (const byte* ptr = m_arena; ptr + sizeof(size_t) <= end;)
+        {
+            size_t block_size = *((const size_t*) ptr);
+
+            if (block_size == 0)
+            {
+                ptr += sizeof(size_t);
+                continue;
+            }
+
+            addExtent(size_t(ptr - last));
+
+            snapshot.live_blocks++;
+            snapshot.live_bytes += block_size;
+
+            ptr += sizeof(size_t) + blockSpan(block_size);
+            last = ptr;
+        }
+
+        addExtent(size_t(end - last));
+
+        if (snapshot.free_bytes > 0)
+            snapshot.fragmentation = 1.0 - (double) snapshot.largest_free_extent / (double) snapshot.free_bytes;
+
+        m_stats.fill(snapshot);
+
+        return snapshot;
     }
 
 
@@ -53,7 +106,7 @@ namespace ADS
             if(ptr == address && *block_size > 0) return true;
             
             // advance the pointer to the end of the memory block
-            ptr += *block_size;
+            ptr += blockSpan(*block_size);
         }
 
         return false;
@@ -66,7 +119,7 @@ namespace ADS
 
         byte* last = m_arena;
 
-        for(byte* ptr = m_arena; ptr < m_arena + m_arena_size;)
+        for(byte* ptr = m_arena; ptr + sizeof(size_t) <= m_arena + m_arena_size;)
         {   
             // if the space between two addresses is more than or equal to the requested size, return the adress to the end of the first memoryblock + 1
             if(size_t(ptr - last) >= size)
@@ -81,7 +134,7 @@ namespace ADS
             ptr += sizeof(size_t);
             
             // advance the pointer to the end of the memory block
-            ptr += *block_size;
+            ptr += blockSpan(*block_size);
 
             // only store the ptr as last if memory were allocated
             if(*block_size != 0)
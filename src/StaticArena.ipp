@@ -6,11 +6,16 @@ namespace ADS
     template<typename T>
     T* StaticArena::alloc(size_t amount)
     {
-        byte* ptr = findFreeAddress(amount * sizeof(T));
+        ArenaStats::Timer timer;
 
-        if (!ptr) return nullptr;
+        byte* ptr = findFreeAddress(blockSpan(amount * sizeof(T)));
+
+        if (!ptr)
+        {
+            m_stats.onAlloc(amount * sizeof(T), timer.elapsed(), false);
+            return nullptr;
+        }
 
-        std::cout << (size_t)m_arena << ',' << (size_t)ptr << ',' << (size_t)(ptr - m_arena) << ',' << m_arena_size << '\n';
         *((size_t*)ptr) = amount * sizeof(T);
         ptr += sizeof(size_t);
 
@@ -18,6 +23,8 @@ namespace ADS
         if constexpr (byte() != 0)
             memset(ptr, 0, amount * sizeof(T));
 
+        m_stats.onAlloc(amount * sizeof(T), timer.elapsed(), true);
+
         return (T*)ptr;
     }
 
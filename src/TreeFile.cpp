@@ -0,0 +1,110 @@
+#include "TreeFile.h"
+
+// the platform headers are only included here, so their macros do not leak into the users of TreeFile.h.
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ADS
+{
+	namespace Bases
+	{
+		bool MappedFile::open(const std::string& path)
+		{
+			close();
+
+#ifdef _WIN32
+			m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+			if (m_file == INVALID_HANDLE_VALUE)
+			{
+				m_file = nullptr;
+				return false;
+			}
+
+			LARGE_INTEGER file_size;
+
+			if (!GetFileSizeEx(m_file, &file_size) || file_size.QuadPart == 0)
+			{
+				close();
+				return false;
+			}
+
+			m_size = (size_t)file_size.QuadPart;
+			m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+			if (!m_mapping)
+			{
+				close();
+				return false;
+			}
+
+			m_data = (const uint8_t*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+
+			if (!m_data)
+			{
+				close();
+				return false;
+			}
+#else
+			int file = ::open(path.c_str(), O_RDONLY);
+
+			if (file < 0)
+				return false;
+
+			struct stat file_stat;
+
+			if (fstat(file, &file_stat) != 0 || file_stat.st_size == 0)
+			{
+				::close(file);
+				return false;
+			}
+
+			size_t size = (size_t)file_stat.st_size;
+
+			void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+			// the mapping keeps the file alive, so the descriptor is no longer needed.
+			::close(file);
+
+			if (data == MAP_FAILED)
+				return false;
+
+			m_data = (const uint8_t*)data;
+			m_size = size;
+#endif
+
+			return true;
+		}
+
+		void MappedFile::close()
+		{
+#ifdef _WIN32
+			if (m_data)
+				UnmapViewOfFile(m_data);
+
+			if (m_mapping)
+				CloseHandle(m_mapping);
+
+			if (m_file)
+				CloseHandle(m_file);
+
+			m_mapping = nullptr;
+			m_file = nullptr;
+#else
+			if (m_data)
+				munmap((void*)m_data, m_size);
+#endif
+
+			m_data = nullptr;
+			m_size = 0;
+		}
+	}
+}
@@ -0,0 +1,280 @@
+#pragma once
+
+#include "TreeFile.h"
+
+#include <cstring>
+#include <vector>
+
+namespace ADS
+{
+	namespace Bases
+	{
+		// writes the records of the tree from root in postorder, with links of type TLink.
+		template<typename TLink, typename T, template<typename> class TNode>
+		void writeTreeRecords(std::ostream& stream, const NodeBase<T, TNode>* root)
+		{
+			using Record = TreeFileRecord<T, TLink>;
+
+			// stage 0 = left subtree not written, 1 = right subtree not written, 2 = node not written.
+			struct Frame
+			{
+				const NodeBase<T, TNode>* node;
+				int stage = 0;
+				TLink left_link = 0;
+			};
+
+			std::vector<Frame> node_stack;
+			TLink count = 0;
+			uint8_t record[Record::SIZE];
+
+			if (root)
+				node_stack.push_back({ root });
+
+			while (!node_stack.empty())
+			{
+				// the reference is not used after a push, since it may invalidate it.
+				Frame& frame = node_stack.back();
+				const NodeBase<T, TNode>* node = frame.node;
+
+				if (frame.stage == 0)
+				{
+					frame.stage = 1;
+
+					if (node->left)
+					{
+						node_stack.push_back({ node->left });
+						continue;
+					}
+				}
+
+				if (frame.stage == 1)
+				{
+					frame.stage = 2;
+					// the left child is the last record written before the right subtree, so its index + 1 is the current count.
+					frame.left_link = node->left ? count : 0;
+
+					if (node->right)
+					{
+						node_stack.push_back({ node->right });
+						continue;
+					}
+				}
+
+				TLink link = frame.left_link | (node->right ? Record::RIGHT : 0);
+
+				memset(record, 0, Record::SIZE);
+				memcpy(record, &node->val, sizeof(T));
+				memcpy(record + Record::LINK_OFFSET, &link, sizeof(TLink));
+
+				stream.write((const char*)record, Record::SIZE);
+				count++;
+
+				node_stack.pop_back();
+			}
+		}
+	}
+
+	template<typename T, template<typename> class TNode> requires std::is_trivially_copyable_v<T>
+	bool writeTree(std::ostream& stream, const Bases::NodeBase<T, TNode>* root)
+	{
+		using Record32 = Bases::TreeFileRecord<T, uint32_t>;
+		using Record64 = Bases::TreeFileRecord<T, uint64_t>;
+
+		uint64_t count = 0;
+		std::vector<const Bases::NodeBase<T, TNode>*> node_stack;
+
+		if (root)
+			node_stack.push_back(root);
+
+		while (!node_stack.empty())
+		{
+			const Bases::NodeBase<T, TNode>* node = node_stack.back();
+			node_stack.pop_back();
+			count++;
+
+			if (node->left)
+				node_stack.push_back(node->left);
+			if (node->right)
+				node_stack.push_back(node->right);
+		}
+
+		bool wide_links = count > Record32::MAX_NODES;
+
+		if (wide_links)
+			Bases::writeTreeRecords<uint64_t>(stream, root);
+		else
+			Bases::writeTreeRecords<uint32_t>(stream, root);
+
+		Bases::TreeFileFooter footer;
+		footer.value_size = sizeof(T);
+		footer.link_size = wide_links ? sizeof(uint64_t) : sizeof(uint32_t);
+		footer.record_size = wide_links ? Record64::SIZE : Record32::SIZE;
+		footer.node_count = count;
+
+		stream.write((const char*)&footer, sizeof(footer));
+
+		return stream.good();
+	}
+
+	// MappedTree definitions
+
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	bool MappedTree<T>::open(const std::string& path)
+	{
+		close();
+
+		if (!m_file.open(path))
+			return false;
+
+		m_data = m_file.data();
+		size_t file_size = m_file.size();
+
+		Bases::TreeFileFooter expected;
+		Bases::TreeFileFooter footer;
+
+		if (file_size < sizeof(footer))
+		{
+			close();
+			return false;
+		}
+
+		memcpy(&footer, m_data + file_size - sizeof(footer), sizeof(footer));
+
+		bool wide_links = footer.link_size == sizeof(uint64_t);
+		size_t record_size = wide_links ? Record64::SIZE : Record32::SIZE;
+
+		bool valid = memcmp(footer.magic, expected.magic, sizeof(footer.magic)) == 0
+			&& footer.version == expected.version
+			&& footer.byte_order == expected.byte_order
+			&& footer.value_size == sizeof(T)
+			&& (footer.link_size == sizeof(uint32_t) || wide_links)
+			&& footer.record_size == record_size
+			&& footer.node_count <= (wide_links ? Record64::MAX_NODES : Record32::MAX_NODES)
+			&& footer.node_count <= (file_size - sizeof(footer)) / record_size
+			&& footer.node_count * record_size + sizeof(footer) == file_size;
+
+		if (!valid)
+		{
+			close();
+			return false;
+		}
+
+		m_node_count = footer.node_count;
+		m_record_size = record_size;
+		m_wide_links = wide_links;
+
+		return true;
+	}
+
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	void MappedTree<T>::close()
+	{
+		m_file.close();
+
+		m_data = nullptr;
+		m_node_count = 0;
+		m_record_size = 0;
+		m_wide_links = false;
+	}
+
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	const T* MappedTree<T>::lookup(const T& val) const
+	{
+		if (m_node_count == 0)
+			return nullptr;
+
+		// same search order as SNode::lookup
+		size_t index = m_node_count - 1;
+
+		while (true)
+		{
+			const T* tmp = value(index);
+
+			if (*tmp == val)
+				return tmp;
+			else if (*tmp >= val)
+			{
+				// in postorder every child is stored before its parent, so a corrupted index can not send the search into a loop.
+				uint64_t left_link = leftLink(index);
+
+				if (left_link == 0 || left_link > index)
+					return nullptr;
+
+				index = (size_t)left_link - 1;
+			}
+			else
+			{
+				if (!hasRight(index) || index == 0)
+					return nullptr;
+
+				index = index - 1;
+			}
+		}
+	}
+
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	const T* MappedTree<T>::find(const T& val) const
+	{
+		return findIf([&](const T& other) { return other == val; });
+	}
+
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	template<typename TPred>
+	const T* MappedTree<T>::findIf(TPred pred) const
+	{
+		// the records are contiguous, so every node can be checked without following the tree structure.
+		for (size_t i = 0; i < m_node_count; i++)
+			if (pred(*value(i)))
+				return value(i);
+
+		return nullptr;
+	}
+
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	template<template<typename> class TNode>
+	TNode<T>* MappedTree<T>::toTree() const
+	{
+		// in postorder both subtrees of a node are built before the node itself,
+		// with the right subtree on top of the stack.
+		std::vector<TNode<T>*> node_stack;
+
+		// the links do not describe a single tree, every subtree built so far is freed.
+		auto fail = [&]()
+		{
+			for (TNode<T>* node : node_stack)
+				delete node;
+
+			return nullptr;
+		};
+
+		for (size_t i = 0; i < m_node_count; i++)
+		{
+			bool has_right = hasRight(i);
+			bool has_left = leftLink(i) != 0;
+
+			if (node_stack.size() < (size_t)has_right + (size_t)has_left)
+				return fail();
+
+			TNode<T>* right = has_right ? node_stack.back() : nullptr;
+
+			if (right)
+				node_stack.pop_back();
+
+			TNode<T>* left = has_left ? node_stack.back() : nullptr;
+
+			if (left)
+				node_stack.pop_back();
+
+			TNode<T>* node = new TNode<T>(*value(i));
+			node->left = left;
+			node->right = right;
+
+			node_stack.push_back(node);
+		}
+
+		if (node_stack.size() > 1)
+			return fail();
+
+		return node_stack.empty() ? nullptr : node_stack.back();
+	}
+}